@@ -0,0 +1,64 @@
+#pragma once
+
+#include <sdkconfig.h>
+
+// ====================== 硬件引脚定义 ======================
+// 每块板子一个引脚表，编译时按芯片型号选择，不产生运行时开销
+// 电机方向引脚必须在 GPIO0~31（同一个输出寄存器），见 HBridge.h
+
+// ESP32-S3 SuperMini
+// GPIO19/20 是 USB D-/D+，该板只有 USB 口，不能占用
+struct Esp32S3SuperMiniPins {
+    // 电机驱动引脚（使用L298N或TB6612）
+    static constexpr int MOTOR_A1 = 14;  // 右电机正转
+    static constexpr int MOTOR_A2 = 15;  // 右电机反转
+    static constexpr int MOTOR_B1 = 16;  // 左电机正转
+    static constexpr int MOTOR_B2 = 17;  // 左电机反转
+
+    // 电机使能引脚（PWM速度控制）
+    static constexpr int MOTOR_A_EN = 18;  // 右电机速度
+    static constexpr int MOTOR_B_EN = 12;  // 左电机速度
+
+    static constexpr int SERVO = 13;   // 舵机信号线
+    static constexpr int LED = 21;     // WS2812 LED灯带
+    static constexpr int TRIG = 39;    // 超声波触发
+    static constexpr int ECHO = 40;    // 超声波回波
+    static constexpr int BUTTON = 0;   // BOOT按钮
+
+    // 车轮编码器（PCNT 硬件计数，单相编码器把 B 相设为 -1）
+    static constexpr int ENCODER_A1 = 4;  // 右轮编码器 A 相
+    static constexpr int ENCODER_A2 = 5;  // 右轮编码器 B 相
+    static constexpr int ENCODER_B1 = 6;  // 左轮编码器 A 相
+    static constexpr int ENCODER_B2 = 7;  // 左轮编码器 B 相
+};
+
+// ESP32 DevKit（esp32dev）
+// GPIO34~39 只能输入、GPIO6~11 接 Flash，超声波和编码器改用其他引脚
+struct Esp32DevPins {
+    static constexpr int MOTOR_A1 = 14;
+    static constexpr int MOTOR_A2 = 15;
+    static constexpr int MOTOR_B1 = 16;
+    static constexpr int MOTOR_B2 = 17;
+
+    static constexpr int MOTOR_A_EN = 18;
+    static constexpr int MOTOR_B_EN = 19;
+
+    static constexpr int SERVO = 13;
+    static constexpr int LED = 21;
+    static constexpr int TRIG = 23;
+    static constexpr int ECHO = 22;
+    static constexpr int BUTTON = 0;
+
+    static constexpr int ENCODER_A1 = 32;
+    static constexpr int ENCODER_A2 = 33;
+    static constexpr int ENCODER_B1 = 25;
+    static constexpr int ENCODER_B2 = 26;
+};
+
+#if CONFIG_IDF_TARGET_ESP32S3
+typedef Esp32S3SuperMiniPins Board;
+#elif CONFIG_IDF_TARGET_ESP32
+typedef Esp32DevPins Board;
+#else
+#error "BoardPins.h 没有该芯片的引脚表"
+#endif
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <Arduino.h>
+#include <soc/gpio_reg.h>
+#include <soc/soc.h>
+
+// H 桥方向控制：两个电机的四个方向输入在编译时算好掩码，
+// 切换方向时对 GPIO_OUT 寄存器只做一次写入，四个引脚同时变化，
+// 不会像逐个 digitalWrite 那样短暂经过 IN1=IN2 的中间状态
+//
+// 读改写期间关中断，防止同核上其他任务对 GPIO0~31 的输出写入被覆盖
+template <typename Pins>
+class HBridge {
+public:
+    static_assert(Pins::MOTOR_A1 < 32 && Pins::MOTOR_A2 < 32 && Pins::MOTOR_B1 < 32 && Pins::MOTOR_B2 < 32,
+                  "电机方向引脚必须在 GPIO0~31");
+
+    static void begin() {
+        pinMode(Pins::MOTOR_A1, OUTPUT);
+        pinMode(Pins::MOTOR_A2, OUTPUT);
+        pinMode(Pins::MOTOR_B1, OUTPUT);
+        pinMode(Pins::MOTOR_B2, OUTPUT);
+        write(0);  // 全部低电平，电机滑行
+    }
+
+    static void setDirection(bool leftForward, bool rightForward) {
+        write(level(leftForward, rightForward));
+    }
+
+private:
+    static constexpr uint32_t bit(int pin) { return 1UL << pin; }
+
+    static constexpr uint32_t MASK =
+        bit(Pins::MOTOR_A1) | bit(Pins::MOTOR_A2) | bit(Pins::MOTOR_B1) | bit(Pins::MOTOR_B2);
+
+    // 左电机由 B1/B2 控制，右电机由 A1/A2 控制
+    static constexpr uint32_t level(bool leftForward, bool rightForward) {
+        return (leftForward ? bit(Pins::MOTOR_B1) : bit(Pins::MOTOR_B2)) |
+               (rightForward ? bit(Pins::MOTOR_A1) : bit(Pins::MOTOR_A2));
+    }
+
+    static void write(uint32_t bits) {
+        static portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+        portENTER_CRITICAL(&mux);
+        REG_WRITE(GPIO_OUT_REG, (REG_READ(GPIO_OUT_REG) & ~MASK) | bits);
+        portEXIT_CRITICAL(&mux);
+    }
+};
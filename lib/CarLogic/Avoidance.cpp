@@ -0,0 +1,23 @@
+#include "Avoidance.h"
+
+// 停车 -> 后退 -> 左转 -> 继续前进
+static const AvoidStep AVOID_SEQUENCE[] = {
+    {CarCommand::Stop, 200},
+    {CarCommand::Backward, 300},
+    {CarCommand::Left, 400},
+    {CarCommand::Forward, 0},
+};
+
+float echoToDistance(long durationUs) {
+    if (durationUs == 0) return NO_ECHO_DISTANCE_CM;
+    return durationUs * 0.034f / 2;
+}
+
+const AvoidStep* planAvoidance(float distanceCm, size_t& stepCount) {
+    if (distanceCm >= AVOID_DISTANCE_CM) {
+        stepCount = 0;
+        return nullptr;
+    }
+    stepCount = sizeof(AVOID_SEQUENCE) / sizeof(AVOID_SEQUENCE[0]);
+    return AVOID_SEQUENCE;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "CarCommand.h"
+
+// 避障决策：超声波回波时间 -> 距离 -> 是否需要执行避让动作
+
+static const float AVOID_DISTANCE_CM = 20.0f;
+static const float NO_ECHO_DISTANCE_CM = 999.0f;  // 超时无回波
+
+struct AvoidStep {
+    CarCommand command;
+    uint16_t holdMs;  // 执行后保持的时间
+};
+
+// pulseIn() 返回的回波高电平时间（us）换算为距离，0 表示超时
+float echoToDistance(long durationUs);
+
+// 需要避让时返回动作序列并写入步数，否则返回 nullptr
+const AvoidStep* planAvoidance(float distanceCm, size_t& stepCount);
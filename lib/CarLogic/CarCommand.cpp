@@ -0,0 +1,49 @@
+#include "CarCommand.h"
+
+#include <string.h>
+
+CarCommand parseCommand(const char* text) {
+    if (text == nullptr) return CarCommand::Unknown;
+    // 先按首字母分支，每条指令最多一次 strcmp
+    switch (text[0]) {
+        case 'f': return strcmp(text, "forward") == 0 ? CarCommand::Forward : CarCommand::Unknown;
+        case 'b': return strcmp(text, "backward") == 0 ? CarCommand::Backward : CarCommand::Unknown;
+        case 'l': return strcmp(text, "left") == 0 ? CarCommand::Left : CarCommand::Unknown;
+        case 'r': return strcmp(text, "right") == 0 ? CarCommand::Right : CarCommand::Unknown;
+        case 's': return strcmp(text, "stop") == 0 ? CarCommand::Stop : CarCommand::Unknown;
+        default: return CarCommand::Unknown;
+    }
+}
+
+const char* commandName(CarCommand command) {
+    switch (command) {
+        case CarCommand::Forward: return "forward";
+        case CarCommand::Backward: return "backward";
+        case CarCommand::Left: return "left";
+        case CarCommand::Right: return "right";
+        case CarCommand::Stop: return "stop";
+        default: return "unknown";
+    }
+}
+
+bool planCommand(CarCommand command, int carSpeed, DrivePlan& plan) {
+    switch (command) {
+        case CarCommand::Forward:
+            plan = {carSpeed, carSpeed, true, true, 0, 255, 0};  // 绿色
+            return true;
+        case CarCommand::Backward:
+            plan = {carSpeed, carSpeed, false, false, 255, 0, 0};  // 红色
+            return true;
+        case CarCommand::Left:
+            plan = {carSpeed / 2, carSpeed, true, true, 255, 255, 0};  // 黄色
+            return true;
+        case CarCommand::Right:
+            plan = {carSpeed, carSpeed / 2, true, true, 255, 255, 0};  // 黄色
+            return true;
+        case CarCommand::Stop:
+            plan = {0, 0, true, true, 0, 0, 255};  // 蓝色
+            return true;
+        default:
+            return false;
+    }
+}
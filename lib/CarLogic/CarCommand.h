@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stdint.h>
+
+// 运动指令解析与分发（纯 C++，native 环境可直接测试）
+
+enum class CarCommand : uint8_t {
+    Forward,
+    Backward,
+    Left,
+    Right,
+    Stop,
+    Unknown,
+};
+
+// 一条指令对应的电机输出与指示灯颜色
+struct DrivePlan {
+    int leftSpeed;
+    int rightSpeed;
+    bool leftForward;
+    bool rightForward;
+    uint8_t r, g, b;
+};
+
+CarCommand parseCommand(const char* text);
+const char* commandName(CarCommand command);
+
+// Unknown 返回 false，plan 不修改
+bool planCommand(CarCommand command, int carSpeed, DrivePlan& plan);
@@ -0,0 +1,28 @@
+#include "LedFrame.h"
+
+uint32_t hueToColor(uint16_t hue) {
+    // 把色相映射到 0 ~ 1529，共 6 段，每段一个分量线性变化 255 级
+    uint32_t h = (static_cast<uint32_t>(hue) * 1530 + 32768) / 65536;
+    uint8_t ramp = static_cast<uint8_t>(h % 255);
+    switch (h / 255) {
+        case 0: return packColor(255, ramp, 0);
+        case 1: return packColor(255 - ramp, 255, 0);
+        case 2: return packColor(0, 255, ramp);
+        case 3: return packColor(0, 255 - ramp, 255);
+        case 4: return packColor(ramp, 0, 255);
+        case 5: return packColor(255, 0, 255 - ramp);
+        default: return packColor(255, 0, 0);  // h == 1530，回到红色
+    }
+}
+
+void fillSolid(uint32_t* frame, size_t count, uint8_t r, uint8_t g, uint8_t b) {
+    uint32_t color = packColor(r, g, b);
+    for (size_t i = 0; i < count; i++) frame[i] = color;
+}
+
+void fillRainbow(uint32_t* frame, size_t count, uint16_t hue) {
+    if (count == 0) return;
+    for (size_t i = 0; i < count; i++) {
+        frame[i] = hueToColor(static_cast<uint16_t>(hue + i * 65536UL / count));
+    }
+}
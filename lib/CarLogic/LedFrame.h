@@ -0,0 +1,18 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// LED 帧计算：颜色按 0x00RRGGBB 打包，与 Adafruit_NeoPixel::Color() 一致
+// 帧先算进缓冲区再一次性写入灯带，计算部分可在 native 环境测试
+
+inline uint32_t packColor(uint8_t r, uint8_t g, uint8_t b) {
+    return (static_cast<uint32_t>(r) << 16) | (static_cast<uint32_t>(g) << 8) | b;
+}
+
+// 全饱和、全亮度的 HSV -> RGB，hue 范围 0 ~ 65535（与 ColorHSV() 相同）
+uint32_t hueToColor(uint16_t hue);
+
+void fillSolid(uint32_t* frame, size_t count, uint8_t r, uint8_t g, uint8_t b);
+// 彩虹沿灯带均匀分布一圈，起始色相为 hue
+void fillRainbow(uint32_t* frame, size_t count, uint16_t hue);
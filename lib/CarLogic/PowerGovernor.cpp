@@ -0,0 +1,35 @@
+#include "PowerGovernor.h"
+
+PowerGovernor::PowerGovernor(uint32_t idleTimeoutMs) : idleTimeoutMs_(idleTimeoutMs) {}
+
+void PowerGovernor::noteActivity(uint32_t nowMs) {
+    lastActivity_ = nowMs;
+    wakePending_ = true;
+}
+
+PowerTransition PowerGovernor::update(uint32_t nowMs, bool canIdle) {
+    bool wake = wakePending_;
+    wakePending_ = false;
+
+    if (state_ == PowerState::Idle) {
+        if (!wake && canIdle) return PowerTransition::None;
+        state_ = PowerState::Active;
+        idleTotal_ += nowMs - idleSince_;
+        wakeups_++;
+        return PowerTransition::Wake;
+    }
+
+    // 无符号减法，millis() 溢出后仍然正确
+    if (canIdle && nowMs - lastActivity_ >= idleTimeoutMs_) {
+        state_ = PowerState::Idle;
+        idleSince_ = nowMs;
+        idleEntries_++;
+        return PowerTransition::EnterIdle;
+    }
+    return PowerTransition::None;
+}
+
+uint32_t PowerGovernor::idleTimeMs(uint32_t nowMs) const {
+    if (state_ == PowerState::Idle) return idleTotal_ + (nowMs - idleSince_);
+    return idleTotal_;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <stdint.h>
+
+// 空闲功耗管理：长时间没有指令且允许空闲（电机停止、未开避障）时进入空闲，有指令或按键时立即唤醒
+// 只负责状态判断与统计，降频等硬件动作由调用方根据返回的状态切换执行
+
+enum class PowerState : uint8_t {
+    Active,
+    Idle,
+};
+
+enum class PowerTransition : uint8_t {
+    None,
+    EnterIdle,
+    Wake,
+};
+
+class PowerGovernor {
+public:
+    explicit PowerGovernor(uint32_t idleTimeoutMs);
+
+    // 收到控制指令或按键
+    void noteActivity(uint32_t nowMs);
+    // 周期调用，返回本次发生的状态切换
+    // canIdle：电机停止且没有自主运行的功能（如避障模式）；为 false 时不进入空闲，已空闲则唤醒
+    PowerTransition update(uint32_t nowMs, bool canIdle);
+
+    void setIdleTimeout(uint32_t ms) { idleTimeoutMs_ = ms; }
+
+    PowerState state() const { return state_; }
+    const char* stateName() const { return state_ == PowerState::Idle ? "idle" : "active"; }
+    uint32_t idleEntries() const { return idleEntries_; }
+    uint32_t wakeups() const { return wakeups_; }
+    // 累计空闲时间（含当前这段）
+    uint32_t idleTimeMs(uint32_t nowMs) const;
+
+private:
+    uint32_t idleTimeoutMs_;
+    PowerState state_ = PowerState::Active;
+    bool wakePending_ = false;
+    uint32_t lastActivity_ = 0;
+    uint32_t idleSince_ = 0;
+    uint32_t idleTotal_ = 0;
+    uint32_t idleEntries_ = 0;
+    uint32_t wakeups_ = 0;
+};
@@ -0,0 +1,21 @@
+#include "Telemetry.h"
+
+#include <stdio.h>
+
+size_t formatTelemetry(char* out, size_t size, const TelemetryData& data) {
+    int len = snprintf(out, size,
+                       "{\"distance\":\"%.2f\",\"battery\":\"%d\",\"temperature\":\"%d\","
+                       "\"rssi\":\"%d\",\"memory\":\"%u\",\"uptime\":\"%u\","
+                       "\"speed\":\"%.1f\",\"wheelL\":\"%.0f\",\"wheelR\":\"%.0f\","
+                       "\"odomX\":\"%.1f\",\"odomY\":\"%.1f\",\"heading\":\"%.1f\","
+                       "\"power\":\"%s\",\"cpuMhz\":\"%u\",\"idleCount\":\"%u\","
+                       "\"wakeCount\":\"%u\",\"idleTime\":\"%u\"}",
+                       data.distance, data.battery, data.temperature, data.rssi,
+                       static_cast<unsigned>(data.memoryKb), static_cast<unsigned>(data.uptime),
+                       data.speed, data.wheelLeft, data.wheelRight,
+                       data.odomX, data.odomY, data.heading,
+                       data.power, static_cast<unsigned>(data.cpuMhz), static_cast<unsigned>(data.idleEntries),
+                       static_cast<unsigned>(data.wakeups), static_cast<unsigned>(data.idleTime));
+    if (len < 0 || static_cast<size_t>(len) >= size) return 0;
+    return static_cast<size_t>(len);
+}
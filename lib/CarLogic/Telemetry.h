@@ -0,0 +1,31 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// /data 接口的实时数据，字段与网页脚本一一对应
+struct TelemetryData {
+    float distance;     // cm
+    int battery;        // %
+    int temperature;    // °C
+    int rssi;           // dBm
+    uint32_t memoryKb;  // 剩余堆内存
+    uint32_t uptime;    // s
+    float speed;        // cm/s
+    float wheelLeft;    // 计数/秒
+    float wheelRight;
+    float odomX;        // cm
+    float odomY;
+    float heading;      // °
+    const char* power;  // 电源状态 active / idle
+    uint32_t cpuMhz;
+    uint32_t idleEntries;
+    uint32_t wakeups;
+    uint32_t idleTime;  // 累计空闲时间 s
+};
+
+// 最长输出远小于该值
+static const size_t TELEMETRY_JSON_SIZE = 512;
+
+// 直接格式化到调用方缓冲区，不做堆分配；返回写入长度，缓冲区不足返回 0
+size_t formatTelemetry(char* out, size_t size, const TelemetryData& data);
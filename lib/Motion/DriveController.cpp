@@ -0,0 +1,48 @@
+#include "DriveController.h"
+
+DriveController::DriveController(const PidGains& gains, const OdometryConfig& odometry)
+    : leftPid_(gains), rightPid_(gains), odometry_(odometry) {}
+
+void DriveController::setTarget(float left, float right) {
+    leftTarget_ = left;
+    rightTarget_ = right;
+}
+
+void DriveController::update(int32_t leftCount, int32_t rightCount, float dt) {
+    if (!started_) {
+        lastLeft_ = leftCount;
+        lastRight_ = rightCount;
+        started_ = true;
+    }
+    int32_t deltaLeft = leftCount - lastLeft_;
+    int32_t deltaRight = rightCount - lastRight_;
+    lastLeft_ = leftCount;
+    lastRight_ = rightCount;
+
+    odometry_.update(deltaLeft, deltaRight);
+    if (dt <= 0.0f) return;
+
+    leftSpeed_ = deltaLeft / dt;
+    rightSpeed_ = deltaRight / dt;
+
+    leftOut_ = toOutput(leftTarget_, leftPid_.update(leftTarget_, leftSpeed_, dt), leftPid_);
+    rightOut_ = toOutput(rightTarget_, rightPid_.update(rightTarget_, rightSpeed_, dt), rightPid_);
+
+    bool leftDead = leftTarget_ != 0.0f && leftOut_.pwm >= 255 && deltaLeft == 0;
+    bool rightDead = rightTarget_ != 0.0f && rightOut_.pwm >= 255 && deltaRight == 0;
+    if (!leftDead && !rightDead) noFeedbackPeriods_ = 0;
+    else if (noFeedbackPeriods_ < NO_FEEDBACK_PERIODS) noFeedbackPeriods_++;
+}
+
+WheelOutput DriveController::toOutput(float target, float command, SpeedPid& pid) {
+    // 目标为 0 时直接停转并清空积分，避免在零点附近来回抖动
+    if (target == 0.0f) {
+        pid.reset();
+        return {0, true};
+    }
+    // 不允许反向制动：输出方向与目标相反时只松开电机
+    if ((target > 0.0f) != (command > 0.0f)) return {0, target > 0.0f};
+
+    int pwm = static_cast<int>(command > 0.0f ? command + 0.5f : -command + 0.5f);
+    return {pwm > 255 ? 255 : pwm, target > 0.0f};
+}
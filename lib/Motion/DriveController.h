@@ -0,0 +1,56 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "Odometry.h"
+#include "SpeedPid.h"
+
+// 左右轮速度闭环 + 里程计
+// 由固定周期的控制任务调用 update()，输出交给 setMotorSpeed()
+struct WheelOutput {
+    int pwm;       // 0 ~ 255
+    bool forward;
+};
+
+class DriveController {
+public:
+    DriveController(const PidGains& gains, const OdometryConfig& odometry);
+
+    // 目标轮速，单位 计数/秒，负数为反转
+    void setTarget(float left, float right);
+    // 传入编码器累计计数，dt 为控制周期（秒）
+    void update(int32_t leftCount, int32_t rightCount, float dt);
+
+    WheelOutput leftOutput() const { return leftOut_; }
+    WheelOutput rightOutput() const { return rightOut_; }
+    float leftSpeed() const { return leftSpeed_; }
+    float rightSpeed() const { return rightSpeed_; }
+    float leftTarget() const { return leftTarget_; }
+    float rightTarget() const { return rightTarget_; }
+    // 目标非零、输出已饱和但编码器连续若干周期没有计数：编码器未接或损坏
+    bool feedbackLost() const { return noFeedbackPeriods_ >= NO_FEEDBACK_PERIODS; }
+
+    Odometry& odometry() { return odometry_; }
+    const Odometry& odometry() const { return odometry_; }
+    SpeedPid& leftPid() { return leftPid_; }
+    SpeedPid& rightPid() { return rightPid_; }
+
+    static const int NO_FEEDBACK_PERIODS = 25;  // 20ms 周期下约 0.5s
+
+private:
+    static WheelOutput toOutput(float target, float command, SpeedPid& pid);
+
+    SpeedPid leftPid_;
+    SpeedPid rightPid_;
+    Odometry odometry_;
+    float leftTarget_ = 0.0f;
+    float rightTarget_ = 0.0f;
+    float leftSpeed_ = 0.0f;
+    float rightSpeed_ = 0.0f;
+    int32_t lastLeft_ = 0;
+    int32_t lastRight_ = 0;
+    bool started_ = false;
+    int noFeedbackPeriods_ = 0;
+    WheelOutput leftOut_ = {0, true};
+    WheelOutput rightOut_ = {0, true};
+};
@@ -0,0 +1,29 @@
+#include "Odometry.h"
+
+#include <math.h>
+
+Odometry::Odometry(const OdometryConfig& config)
+    : config_(config),
+      mmPerTick_(static_cast<float>(M_PI) * config.wheelDiameterMm / config.ticksPerRev) {}
+
+void Odometry::update(int32_t deltaLeft, int32_t deltaRight) {
+    float left = deltaLeft * mmPerTick_;
+    float right = deltaRight * mmPerTick_;
+    float distance = (left + right) * 0.5f;
+    float dTheta = (right - left) / config_.trackWidthMm;
+
+    // 中点积分：用本周期航向变化的一半计算位移方向
+    float mid = heading_ + dTheta * 0.5f;
+    x_ += distance * cosf(mid);
+    y_ += distance * sinf(mid);
+
+    heading_ += dTheta;
+    while (heading_ > static_cast<float>(M_PI)) heading_ -= 2.0f * static_cast<float>(M_PI);
+    while (heading_ < -static_cast<float>(M_PI)) heading_ += 2.0f * static_cast<float>(M_PI);
+}
+
+void Odometry::reset() {
+    x_ = 0.0f;
+    y_ = 0.0f;
+    heading_ = 0.0f;
+}
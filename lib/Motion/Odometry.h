@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stdint.h>
+
+// 差速航位推算里程计：由左右轮编码器增量估计车体位姿
+// 坐标单位 mm，航向单位 rad（逆时针为正，上电时朝向 +x）
+
+struct OdometryConfig {
+    float ticksPerRev;      // 车轮转一圈的编码器计数
+    float wheelDiameterMm;  // 车轮直径
+    float trackWidthMm;     // 左右轮距
+};
+
+class Odometry {
+public:
+    explicit Odometry(const OdometryConfig& config);
+
+    void update(int32_t deltaLeft, int32_t deltaRight);
+    void reset();
+
+    float x() const { return x_; }
+    float y() const { return y_; }
+    float heading() const { return heading_; }
+    float mmPerTick() const { return mmPerTick_; }
+
+private:
+    OdometryConfig config_;
+    float mmPerTick_;
+    float x_ = 0.0f;
+    float y_ = 0.0f;
+    float heading_ = 0.0f;
+};
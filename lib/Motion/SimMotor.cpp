@@ -0,0 +1,32 @@
+#include "SimMotor.h"
+
+#include "WheelEncoder.h"
+
+SimMotor::SimMotor(const SimMotorParams& params, WheelEncoder* encoder)
+    : params_(params), encoder_(encoder) {}
+
+void SimMotor::drive(int pwm, bool forward) {
+    pwm_ = pwm < 0 ? 0 : (pwm > 255 ? 255 : pwm);
+    forward_ = forward;
+}
+
+int32_t SimMotor::step(float dt) {
+    float effective = pwm_ - params_.deadbandPwm;
+    if (effective < 0.0f) effective = 0.0f;
+    float target = params_.maxTicksPerSec * supplyScale_ * (1.0f - load_) *
+                   effective / (255.0f - params_.deadbandPwm);
+    if (!forward_) target = -target;
+
+    float alpha = dt / (params_.timeConstant + dt);
+    speed_ += (target - speed_) * alpha;
+
+    // 保留小数部分，避免低速时脉冲被截断
+    fraction_ += speed_ * dt;
+    int32_t ticks = static_cast<int32_t>(fraction_);
+    fraction_ -= ticks;
+
+#ifndef ESP_PLATFORM
+    if (encoder_) encoder_->simAddTicks(ticks);
+#endif
+    return ticks;
+}
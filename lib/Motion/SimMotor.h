@@ -0,0 +1,38 @@
+#pragma once
+
+#include <stdint.h>
+
+class WheelEncoder;
+
+// 模拟 HAL：直流减速电机 + 编码器的一阶模型，用于在 Linux 上调试速度闭环
+// 稳态转速与 PWM 超出死区的部分成正比，并受电池电压和负载影响
+struct SimMotorParams {
+    float maxTicksPerSec;  // 满电、空载、PWM 255 时的稳态轮速（计数/秒）
+    float deadbandPwm;     // 低于该 PWM 电机不转
+    float timeConstant;    // 机械时间常数（秒）
+};
+
+class SimMotor {
+public:
+    explicit SimMotor(const SimMotorParams& params, WheelEncoder* encoder = nullptr);
+
+    // 与 setMotorSpeed() 对应的驱动输入
+    void drive(int pwm, bool forward);
+    // 推进 dt 秒，产生的编码器脉冲写入绑定的编码器，返回本步带符号计数
+    int32_t step(float dt);
+
+    void setSupplyScale(float scale) { supplyScale_ = scale; }  // 1.0 为满电
+    void setLoad(float load) { load_ = load; }                  // 0 空载 ~ 1 堵转
+
+    float speed() const { return speed_; }
+
+private:
+    SimMotorParams params_;
+    WheelEncoder* encoder_;
+    int pwm_ = 0;
+    bool forward_ = true;
+    float supplyScale_ = 1.0f;
+    float load_ = 0.0f;
+    float speed_ = 0.0f;
+    float fraction_ = 0.0f;
+};
@@ -0,0 +1,35 @@
+#include "SpeedPid.h"
+
+SpeedPid::SpeedPid(const PidGains& gains, float outMin, float outMax)
+    : gains_(gains), outMin_(outMin), outMax_(outMax) {}
+
+float SpeedPid::update(float target, float measured, float dt) {
+    if (dt <= 0.0f) return 0.0f;
+
+    float error = target - measured;
+    float derivative = hasLast_ ? -(measured - lastMeasured_) / dt : 0.0f;
+    lastMeasured_ = measured;
+    hasLast_ = true;
+
+    float base = gains_.kf * target + gains_.kp * error + gains_.kd * derivative;
+    float candidate = integral_ + gains_.ki * error * dt;
+    float output = base + candidate;
+
+    // 抗积分饱和：输出饱和且误差继续推向饱和方向时不再累加积分
+    if (output > outMax_) {
+        if (error < 0.0f) integral_ = candidate;
+        output = outMax_;
+    } else if (output < outMin_) {
+        if (error > 0.0f) integral_ = candidate;
+        output = outMin_;
+    } else {
+        integral_ = candidate;
+    }
+    return output;
+}
+
+void SpeedPid::reset() {
+    integral_ = 0.0f;
+    lastMeasured_ = 0.0f;
+    hasLast_ = false;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+// 单轮速度 PID 控制器（纯 C++，不依赖 Arduino，可在 native 环境下调参）
+// 输入/反馈单位为 编码器计数/秒，输出为带符号 PWM（-255 ~ 255）
+
+struct PidGains {
+    float kp;  // 比例
+    float ki;  // 积分
+    float kd;  // 微分（作用在反馈量上，避免目标突变时的冲击）
+    float kf;  // 前馈：目标速度 -> PWM 的线性系数
+};
+
+class SpeedPid {
+public:
+    explicit SpeedPid(const PidGains& gains, float outMin = -255.0f, float outMax = 255.0f);
+
+    // 计算一次控制输出，dt 单位为秒
+    float update(float target, float measured, float dt);
+    void reset();
+
+    void setGains(const PidGains& gains) { gains_ = gains; }
+    const PidGains& gains() const { return gains_; }
+
+private:
+    PidGains gains_;
+    float outMin_;
+    float outMax_;
+    float integral_ = 0.0f;
+    float lastMeasured_ = 0.0f;
+    bool hasLast_ = false;
+};
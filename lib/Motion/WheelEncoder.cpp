@@ -0,0 +1,110 @@
+#include "WheelEncoder.h"
+
+#ifdef ESP_PLATFORM
+
+#include <driver/pcnt.h>
+#include <freertos/FreeRTOS.h>
+
+// PCNT 计数器为 16 位，计到上下限后硬件自动清零
+static const int16_t COUNTER_LIMIT = 30000;
+// 毛刺滤波：短于该 APB 周期数（80MHz 下约 1.25us）的脉冲被忽略
+static const uint16_t FILTER_CYCLES = 100;
+
+static portMUX_TYPE encoderMux = portMUX_INITIALIZER_UNLOCKED;
+static int nextUnit = 0;
+static bool isrServiceInstalled = false;
+
+void WheelEncoder::onLimit(void* arg) {
+    WheelEncoder* encoder = static_cast<WheelEncoder*>(arg);
+    uint32_t status = 0;
+    pcnt_get_event_status(static_cast<pcnt_unit_t>(encoder->unit_), &status);
+
+    portENTER_CRITICAL_ISR(&encoderMux);
+    if (status & PCNT_EVT_H_LIM) encoder->overflow_ += COUNTER_LIMIT;
+    if (status & PCNT_EVT_L_LIM) encoder->overflow_ -= COUNTER_LIMIT;
+    portEXIT_CRITICAL_ISR(&encoderMux);
+}
+
+bool WheelEncoder::begin(int pinA, int pinB) {
+    if (nextUnit >= PCNT_UNIT_MAX) return false;
+    unit_ = nextUnit++;
+    quadrature_ = pinB >= 0;
+    pcnt_unit_t unit = static_cast<pcnt_unit_t>(unit_);
+
+    // 通道 0：A 相为脉冲，B 相为方向（A 超前 B 为正转）
+    pcnt_config_t config = {};
+    config.pulse_gpio_num = pinA;
+    config.ctrl_gpio_num = quadrature_ ? pinB : PCNT_PIN_NOT_USED;
+    config.unit = unit;
+    config.channel = PCNT_CHANNEL_0;
+    config.pos_mode = PCNT_COUNT_INC;
+    config.neg_mode = quadrature_ ? PCNT_COUNT_DEC : PCNT_COUNT_INC;
+    config.lctrl_mode = PCNT_MODE_KEEP;
+    // 单相时控制脚未接，两种电平都保持计数方向
+    config.hctrl_mode = quadrature_ ? PCNT_MODE_REVERSE : PCNT_MODE_KEEP;
+    config.counter_h_lim = COUNTER_LIMIT;
+    config.counter_l_lim = -COUNTER_LIMIT;
+    if (pcnt_unit_config(&config) != ESP_OK) return false;
+
+    // 通道 1：B 相为脉冲，A 相为方向，与通道 0 合成四倍频计数
+    if (quadrature_) {
+        config.pulse_gpio_num = pinB;
+        config.ctrl_gpio_num = pinA;
+        config.channel = PCNT_CHANNEL_1;
+        config.pos_mode = PCNT_COUNT_DEC;
+        config.neg_mode = PCNT_COUNT_INC;
+        if (pcnt_unit_config(&config) != ESP_OK) return false;
+    }
+
+    pcnt_set_filter_value(unit, FILTER_CYCLES);
+    pcnt_filter_enable(unit);
+
+    pcnt_event_enable(unit, PCNT_EVT_H_LIM);
+    pcnt_event_enable(unit, PCNT_EVT_L_LIM);
+    if (!isrServiceInstalled) {
+        if (pcnt_isr_service_install(0) != ESP_OK) return false;
+        isrServiceInstalled = true;
+    }
+    pcnt_isr_handler_add(unit, onLimit, this);
+
+    pcnt_counter_pause(unit);
+    pcnt_counter_clear(unit);
+    pcnt_counter_resume(unit);
+    return true;
+}
+
+int32_t WheelEncoder::readRaw() {
+    int16_t count = 0;
+    portENTER_CRITICAL(&encoderMux);
+    pcnt_get_counter_value(static_cast<pcnt_unit_t>(unit_), &count);
+    int32_t total = overflow_ + count;
+    portEXIT_CRITICAL(&encoderMux);
+
+    // 计数器到达上下限后硬件立即清零，但溢出中断可能还没处理（本核关中断或中断延迟），
+    // 此时 overflow_ 仍是旧值。两次读取之间不可能走过半个量程，跳变超过半量程即按回绕修正
+    int32_t jump = total - lastTotal_;
+    if (jump < -COUNTER_LIMIT / 2) total += COUNTER_LIMIT;
+    else if (jump > COUNTER_LIMIT / 2) total -= COUNTER_LIMIT;
+    lastTotal_ = total;
+    return total;
+}
+
+#else
+
+bool WheelEncoder::begin(int pinA, int pinB) {
+    (void)pinA;
+    quadrature_ = pinB >= 0;
+    rawTotal_ = 0;
+    return true;
+}
+
+#endif
+
+int32_t WheelEncoder::read() {
+    int32_t raw = readRaw();
+    int32_t delta = raw - lastRaw_;
+    lastRaw_ = raw;
+    // 单相编码器只会递增，按驱动方向补上符号
+    position_ += (quadrature_ || forward_) ? delta : -delta;
+    return position_;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <stdint.h>
+
+// 车轮编码器
+// ESP32 上使用 PCNT 硬件计数器计数，计数过程不产生逐脉冲中断，
+// 只有计数器达到上下限时进入一次中断把溢出量累加到 32 位计数。
+// native 环境下没有 PCNT，由模拟 HAL（SimMotor）通过 simAddTicks() 注入脉冲。
+//
+// pinB < 0 时为单相编码器：无法分辨转向，计数符号取自 setDirection()。
+class WheelEncoder {
+public:
+    bool begin(int pinA, int pinB = -1);
+
+    // 累计计数（带符号）
+    int32_t read();
+
+    // 单相编码器的转向，由当前电机驱动方向决定
+    void setDirection(bool forward) { forward_ = forward; }
+
+#ifndef ESP_PLATFORM
+    // 单相时与硬件一致，只累加脉冲个数
+    void simAddTicks(int32_t ticks) { rawTotal_ += (quadrature_ || ticks >= 0) ? ticks : -ticks; }
+#endif
+
+private:
+    bool quadrature_ = false;
+    bool forward_ = true;
+    int32_t lastRaw_ = 0;
+    int32_t position_ = 0;
+#ifdef ESP_PLATFORM
+    static void onLimit(void* arg);
+    int32_t readRaw();
+
+    int unit_ = -1;
+    volatile int32_t overflow_ = 0;
+    int32_t lastTotal_ = 0;
+#else
+    int32_t readRaw() { return rawTotal_; }
+
+    int32_t rawTotal_ = 0;
+#endif
+};
@@ -6,32 +6,43 @@
 #include <ESPmDNS.h>
 #include <SPIFFS.h>
 #include <ESP32Servo.h>
+#include <Avoidance.h>
+#include <CarCommand.h>
+#include <DriveController.h>
+#include <LedFrame.h>
+#include <PowerGovernor.h>
+#include <Telemetry.h>
+#include <WheelEncoder.h>
 
-// ====================== 硬件引脚定义（ESP32-S3 SuperMini） ======================
-// 电机驱动引脚（使用L298N或TB6612）
-#define MOTOR_A1 14  // 右电机正转
-#define MOTOR_A2 15  // 右电机反转
-#define MOTOR_B1 16  // 左电机正转
-#define MOTOR_B2 17  // 左电机反转
+#include "BoardPins.h"
+#include "HBridge.h"
 
-// 电机使能引脚（PWM速度控制）
-#define MOTOR_A_EN 18  // 右电机速度
-#define MOTOR_B_EN 19  // 左电机速度
-
-// 舵机引脚
-#define SERVO_PIN 13  // 舵机信号线
+// ====================== 硬件配置 ======================
+// 引脚表见 include/BoardPins.h，按编译目标自动选择 esp32dev 或 ESP32-S3 SuperMini
+typedef HBridge<Board> MotorBridge;
 
 // WS2812 LED灯带
-#define LED_PIN 21
 #define LED_COUNT 8
-Adafruit_NeoPixel strip(LED_COUNT, LED_PIN, NEO_GRB + NEO_KHZ800);
-
-// 超声波传感器
-#define TRIG_PIN 39
-#define ECHO_PIN 40
-
-// 按键引脚
-#define BUTTON_PIN 0  // BOOT按钮
+Adafruit_NeoPixel strip(LED_COUNT, Board::LED, NEO_GRB + NEO_KHZ800);
+
+// ====================== 速度闭环与里程计配置 ======================
+#define ENABLE_SPEED_LOOP 1        // 0 = 保持原来的开环 PWM 控制；编码器初始化失败或无反馈时也会自动切回开环
+#define SPEED_LOOP_PERIOD_MS 20    // 速度环周期
+#define ENCODER_TICKS_PER_REV 1320 // 11 线霍尔 x 1:30 减速 x 4 倍频（单相编码器减半）
+#define WHEEL_DIAMETER_MM 65
+#define TRACK_WIDTH_MM 150
+#define MAX_WHEEL_TPS 6000.0f      // carSpeed=255 对应的目标轮速（计数/秒），需按实测标定
+
+const PidGains speedGains = {0.03f, 0.6f, 0.0f, 255.0f / MAX_WHEEL_TPS};
+const OdometryConfig odometryConfig = {ENCODER_TICKS_PER_REV, WHEEL_DIAMETER_MM, TRACK_WIDTH_MM};
+
+// ====================== 功耗管理配置 ======================
+#define IDLE_TIMEOUT_MS 60000            // 无指令且电机停止超过该时间进入空闲（运行时可用 /power?idleTimeout=秒 修改）
+#define ACTIVE_CPU_MHZ 240
+#define IDLE_CPU_MHZ 80                  // 80MHz 是 WiFi 仍可工作的最低主频
+#define IDLE_POLL_MS 20                  // 空闲时每次 loop 的阻塞等待，即唤醒延迟上限
+#define ACTIVE_TX_POWER WIFI_POWER_19_5dBm
+#define IDLE_TX_POWER WIFI_POWER_11dBm   // 空闲时降低发射功率，附近仍可连接热点
 
 // ====================== WiFi 热点配置 ======================
 const char* apSSID = "ESP32-SmartCar";
@@ -49,6 +60,20 @@ int servoAngle = 90;   // 舵机角度 0-180
 bool obstacleAvoidance = false;  // 避障模式
 Servo steeringServo;   // 舵机对象
 
+WheelEncoder leftEncoder;
+WheelEncoder rightEncoder;
+DriveController driveController(speedGains, odometryConfig);
+portMUX_TYPE motionMux = portMUX_INITIALIZER_UNLOCKED;  // 保护 driveController 的目标与状态
+bool motorsStopped = true;
+volatile bool closedLoop = ENABLE_SPEED_LOOP;  // 运行时是否使用速度闭环
+WheelOutput openLoopLeft = {0, true};   // 最近一次指令的开环输出，切回开环时直接使用
+WheelOutput openLoopRight = {0, true};
+
+PowerGovernor powerGovernor(IDLE_TIMEOUT_MS);
+TaskHandle_t loopTaskHandle = NULL;  // 按键中断通过任务通知提前唤醒 loop()
+TaskHandle_t speedLoopHandle = NULL;
+volatile bool speedLoopParked = false;  // 空闲时速度环停止运行，唤醒时恢复
+
 // ====================== 网页界面HTML ======================
 const char* MAIN_page = R"rawliteral(
 <!DOCTYPE html>
@@ -308,6 +333,18 @@ const char* MAIN_page = R"rawliteral(
                 <span>内存使用:</span>
                 <span id="memory">-- KB</span>
             </div>
+            <div class="data-item">
+                <span>轮速 (左/右):</span>
+                <span id="wheels">-- / --</span>
+            </div>
+            <div class="data-item">
+                <span>里程计:</span>
+                <span id="odometry">X: -- cm, Y: -- cm, 航向: --°</span>
+            </div>
+            <div class="data-item">
+                <span>电源状态:</span>
+                <span id="power">--</span>
+            </div>
         </div>
     </div>
 
@@ -433,6 +470,12 @@ const char* MAIN_page = R"rawliteral(
                     document.getElementById('rssi').textContent = data.rssi;
                     document.getElementById('memory').textContent = data.memory;
                     document.getElementById('uptime').textContent = data.uptime + 's';
+                    document.getElementById('speed').textContent = data.speed + ' cm/s';
+                    document.getElementById('wheels').textContent = data.wheelL + ' / ' + data.wheelR;
+                    document.getElementById('odometry').textContent =
+                        `X: ${data.odomX} cm, Y: ${data.odomY} cm, 航向: ${data.heading}°`;
+                    document.getElementById('power').textContent =
+                        `${data.power === 'idle' ? '空闲' : '运行'} ${data.cpuMhz}MHz（空闲 ${data.idleCount} 次，唤醒 ${data.wakeCount} 次，共 ${data.idleTime}s）`;
                 });
         }
 
@@ -451,16 +494,13 @@ void initGPIO() {
     Serial.begin(115200);
     
     // 初始化电机引脚
-    pinMode(MOTOR_A1, OUTPUT);
-    pinMode(MOTOR_A2, OUTPUT);
-    pinMode(MOTOR_B1, OUTPUT);
-    pinMode(MOTOR_B2, OUTPUT);
-    pinMode(MOTOR_A_EN, OUTPUT);
-    pinMode(MOTOR_B_EN, OUTPUT);
+    MotorBridge::begin();
+    pinMode(Board::MOTOR_A_EN, OUTPUT);
+    pinMode(Board::MOTOR_B_EN, OUTPUT);
     
     // 初始化超声波引脚
-    pinMode(TRIG_PIN, OUTPUT);
-    pinMode(ECHO_PIN, INPUT);
+    pinMode(Board::TRIG, OUTPUT);
+    pinMode(Board::ECHO, INPUT);
     
     // 初始化 LED 灯带
     strip.begin();
@@ -468,11 +508,17 @@ void initGPIO() {
     strip.setBrightness(50);
     
     // 初始化舵机
-    steeringServo.attach(SERVO_PIN);
+    steeringServo.attach(Board::SERVO);
     steeringServo.write(servoAngle);
     
     // 初始化按键
-    pinMode(BUTTON_PIN, INPUT_PULLUP);
+    pinMode(Board::BUTTON, INPUT_PULLUP);
+    
+    // 初始化编码器
+    if (!rightEncoder.begin(Board::ENCODER_A1, Board::ENCODER_A2) || !leftEncoder.begin(Board::ENCODER_B1, Board::ENCODER_B2)) {
+        Serial.println("编码器初始化失败，使用开环控制");
+        closedLoop = false;
+    }
     
     Serial.println("GPIO 初始化完成");
 }
@@ -483,101 +529,188 @@ void setMotorSpeed(int leftSpeed, int rightSpeed, bool leftForward = true, bool
     leftSpeed = constrain(leftSpeed, 0, 255);
     rightSpeed = constrain(rightSpeed, 0, 255);
     
-    // 左电机
-    if (leftForward) {
-        digitalWrite(MOTOR_B1, HIGH);
-        digitalWrite(MOTOR_B2, LOW);
-    } else {
-        digitalWrite(MOTOR_B1, LOW);
-        digitalWrite(MOTOR_B2, HIGH);
+    // 四个方向引脚一次写入，再设置两路速度
+    MotorBridge::setDirection(leftForward, rightForward);
+    analogWrite(Board::MOTOR_B_EN, leftSpeed);
+    analogWrite(Board::MOTOR_A_EN, rightSpeed);
+}
+
+// 设置目标车速：闭环时交给速度环，否则直接输出 PWM
+void driveMotors(int leftSpeed, int rightSpeed, bool leftForward = true, bool rightForward = true) {
+    motorsStopped = leftSpeed <= 0 && rightSpeed <= 0;
+    leftSpeed = constrain(leftSpeed, 0, 255);
+    rightSpeed = constrain(rightSpeed, 0, 255);
+    float left = leftSpeed * MAX_WHEEL_TPS / 255.0f;
+    float right = rightSpeed * MAX_WHEEL_TPS / 255.0f;
+    
+    portENTER_CRITICAL(&motionMux);
+    openLoopLeft = {leftSpeed, leftForward};
+    openLoopRight = {rightSpeed, rightForward};
+    bool useSpeedLoop = closedLoop;
+    if (useSpeedLoop) {
+        driveController.setTarget(leftForward ? left : -left, rightForward ? right : -right);
     }
-    analogWrite(MOTOR_B_EN, leftSpeed);
+    portEXIT_CRITICAL(&motionMux);
     
-    // 右电机
-    if (rightForward) {
-        digitalWrite(MOTOR_A1, HIGH);
-        digitalWrite(MOTOR_A2, LOW);
-    } else {
-        digitalWrite(MOTOR_A1, LOW);
-        digitalWrite(MOTOR_A2, HIGH);
+    if (!useSpeedLoop) {
+        leftEncoder.setDirection(leftForward);
+        rightEncoder.setDirection(rightForward);
+        setMotorSpeed(leftSpeed, rightSpeed, leftForward, rightForward);
     }
-    analogWrite(MOTOR_A_EN, rightSpeed);
 }
 
-// 设置 LED 颜色
-void setLEDColor(uint8_t r, uint8_t g, uint8_t b) {
-    for (int i = 0; i < strip.numPixels(); i++) {
-        strip.setPixelColor(i, strip.Color(r, g, b));
+// 速度环任务：固定周期读取编码器、更新 PID 与里程计
+void speedLoopTask(void* param) {
+    const float dt = SPEED_LOOP_PERIOD_MS / 1000.0f;
+    TickType_t lastWake = xTaskGetTickCount();
+    WheelOutput lastLeft = {-1, true};
+    WheelOutput lastRight = {-1, true};
+    for (;;) {
+        if (speedLoopParked) {
+            // 空闲期间阻塞等待唤醒通知；恢复后只把停放期间的计数计入里程计，不计算速度
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            int32_t leftCount = leftEncoder.read();
+            int32_t rightCount = rightEncoder.read();
+            portENTER_CRITICAL(&motionMux);
+            driveController.update(leftCount, rightCount, 0);
+            portEXIT_CRITICAL(&motionMux);
+            lastWake = xTaskGetTickCount();
+            continue;
+        }
+        vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(SPEED_LOOP_PERIOD_MS));
+        
+        int32_t leftCount = leftEncoder.read();
+        int32_t rightCount = rightEncoder.read();
+        
+        portENTER_CRITICAL(&motionMux);
+        driveController.update(leftCount, rightCount, dt);
+        bool wasClosedLoop = closedLoop;
+        // 编码器没有反馈时不能一直输出满 PWM，切回开环并按最近一次指令输出
+        if (wasClosedLoop && driveController.feedbackLost()) closedLoop = false;
+        WheelOutput left = closedLoop ? driveController.leftOutput() : openLoopLeft;
+        WheelOutput right = closedLoop ? driveController.rightOutput() : openLoopRight;
+        portEXIT_CRITICAL(&motionMux);
+        
+        if (!wasClosedLoop) continue;  // 开环时由 driveMotors() 直接输出
+        if (!closedLoop) Serial.println("编码器无反馈，切换为开环控制");
+        
+        // 输出没有变化时不重复写寄存器
+        if (left.pwm == lastLeft.pwm && left.forward == lastLeft.forward &&
+            right.pwm == lastRight.pwm && right.forward == lastRight.forward) {
+            continue;
+        }
+        lastLeft = left;
+        lastRight = right;
+        leftEncoder.setDirection(left.forward);
+        rightEncoder.setDirection(right.forward);
+        setMotorSpeed(left.pwm, right.pwm, left.forward, right.forward);
+    }
+}
+
+// 把一帧颜色写入灯带
+void showFrame(const uint32_t* frame) {
+    for (int i = 0; i < LED_COUNT; i++) {
+        strip.setPixelColor(i, frame[i]);
     }
     strip.show();
 }
 
+// 设置 LED 颜色
+void setLEDColor(uint8_t r, uint8_t g, uint8_t b) {
+    uint32_t frame[LED_COUNT];
+    fillSolid(frame, LED_COUNT, r, g, b);
+    showFrame(frame);
+}
+
 // 控制小车运动
-void controlCar(String command) {
-    Serial.println("控制命令: " + command);
+void controlCar(CarCommand command) {
+    DrivePlan plan;
+    if (!planCommand(command, carSpeed, plan)) return;
     
-    if (command == "forward") {
-        setMotorSpeed(carSpeed, carSpeed, true, true);
-        setLEDColor(0, 255, 0); // 绿色
-    } else if (command == "backward") {
-        setMotorSpeed(carSpeed, carSpeed, false, false);
-        setLEDColor(255, 0, 0); // 红色
-    } else if (command == "left") {
-        setMotorSpeed(carSpeed/2, carSpeed, true, true);
-        setLEDColor(255, 255, 0); // 黄色
-    } else if (command == "right") {
-        setMotorSpeed(carSpeed, carSpeed/2, true, true);
-        setLEDColor(255, 255, 0); // 黄色
-    } else if (command == "stop") {
-        setMotorSpeed(0, 0);
-        setLEDColor(0, 0, 255); // 蓝色
-    }
+    driveMotors(plan.leftSpeed, plan.rightSpeed, plan.leftForward, plan.rightForward);
+    setLEDColor(plan.r, plan.g, plan.b);
 }
 
-
+void controlCar(const String& command) {
+    Serial.println("控制命令: " + command);
+    controlCar(parseCommand(command.c_str()));
+}
 
 // LED 彩虹效果
 void rainbowLED() {
     static uint16_t hue = 0;
-    for (int i = 0; i < strip.numPixels(); i++) {
-        strip.setPixelColor(i, strip.ColorHSV((hue + i * 65536L / strip.numPixels()) & 65535));
-    }
-    strip.show();
+    uint32_t frame[LED_COUNT];
+    fillRainbow(frame, LED_COUNT, hue);
+    showFrame(frame);
     hue += 256;
 }
 
 // 读取超声波距离
 float readDistance() {
-    digitalWrite(TRIG_PIN, LOW);
+    digitalWrite(Board::TRIG, LOW);
     delayMicroseconds(2);
-    digitalWrite(TRIG_PIN, HIGH);
+    digitalWrite(Board::TRIG, HIGH);
     delayMicroseconds(10);
-    digitalWrite(TRIG_PIN, LOW);
-    
-    long duration = pulseIn(ECHO_PIN, HIGH, 30000);
-    if (duration == 0) return 999.0;
+    digitalWrite(Board::TRIG, LOW);
     
-    float distance = duration * 0.034 / 2;
-    return distance;
+    return echoToDistance(pulseIn(Board::ECHO, HIGH, 30000));
 }
 
 // 避障功能
 void obstacleAvoidanceTask() {
     if (!obstacleAvoidance) return;
     
-    float distance = readDistance();
-    if (distance < 20.0) {
-        // 前方有障碍物
-        controlCar("stop");
-        delay(200);
-        controlCar("backward");
-        delay(300);
-        controlCar("left");
-        delay(400);
-        controlCar("forward");
+    size_t stepCount = 0;
+    const AvoidStep* steps = planAvoidance(readDistance(), stepCount);
+    // 前方有障碍物时依次执行避让动作
+    for (size_t i = 0; i < stepCount; i++) {
+        controlCar(steps[i].command);
+        if (steps[i].holdMs) delay(steps[i].holdMs);
+    }
+}
+
+// 执行空闲/唤醒切换
+// 热点模式下 WiFi 不支持 modem sleep，light sleep 会断开热点，
+// 因此空闲时降低主频和发射功率、停掉速度环，并让 loop() 阻塞等待，CPU 在空闲任务中停顿
+void powerTask() {
+    // 避障模式下随时可能需要自主避让，速度环必须保持运行，不进入空闲
+    switch (powerGovernor.update(millis(), motorsStopped && !obstacleAvoidance)) {
+        case PowerTransition::EnterIdle:
+            speedLoopParked = true;  // 电机已停止，速度环不再需要周期运行
+            setCpuFrequencyMhz(IDLE_CPU_MHZ);
+            WiFi.setTxPower(IDLE_TX_POWER);
+            Serial.println("进入空闲省电模式");
+            break;
+        case PowerTransition::Wake:
+            setCpuFrequencyMhz(ACTIVE_CPU_MHZ);
+            WiFi.setTxPower(ACTIVE_TX_POWER);
+            speedLoopParked = false;
+            if (speedLoopHandle) xTaskNotifyGive(speedLoopHandle);
+            Serial.println("退出空闲省电模式");
+            break;
+        default:
+            break;
     }
 }
 
+// 收到指令或按键：记录活动并立即恢复全速
+void markActivity() {
+    powerGovernor.noteActivity(millis());
+    powerTask();
+}
+
+// 空闲时阻塞等待，按键中断可提前结束等待
+void idleWait() {
+    if (powerGovernor.state() != PowerState::Idle) return;
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(IDLE_POLL_MS));
+}
+
+void IRAM_ATTR onButtonPress() {
+    BaseType_t woken = pdFALSE;
+    if (loopTaskHandle) vTaskNotifyGiveFromISR(loopTaskHandle, &woken);
+    if (woken) portYIELD_FROM_ISR();
+}
+
 // 初始化 WiFi 热点
 void initWiFiAP() {
     Serial.println("正在启动 WiFi 热点...");
@@ -608,10 +741,12 @@ void initWiFiAP() {
 
 // Web 服务器路由处理
 void handleRoot() {
+    markActivity();
     server.send(200, "text/html", MAIN_page);
 }
 
 void handleControl() {
+    markActivity();
     if (server.hasArg("cmd")) {
         String cmd = server.arg("cmd");
         controlCar(cmd);
@@ -620,6 +755,7 @@ void handleControl() {
 }
 
 void handleSpeed() {
+    markActivity();
     if (server.hasArg("value")) {
         carSpeed = map(server.arg("value").toInt(), 0, 100, 0, 255);
         server.send(200, "text/plain", "Speed: " + String(carSpeed));
@@ -627,6 +763,7 @@ void handleSpeed() {
 }
 
 void handleServo() {
+    markActivity();
     if (server.hasArg("angle")) {
         servoAngle = server.arg("angle").toInt();
         steeringServo.write(servoAngle);
@@ -635,6 +772,7 @@ void handleServo() {
 }
 
 void handleLED() {
+    markActivity();
     if (server.hasArg("color")) {
         String color = server.arg("color");
         if (color == "red") setLEDColor(255, 0, 0);
@@ -648,23 +786,50 @@ void handleLED() {
 }
 
 void handleAvoidance() {
+    markActivity();
     if (server.hasArg("enable")) {
         obstacleAvoidance = (server.arg("enable") == "true");
         server.send(200, "text/plain", obstacleAvoidance ? "避障开启" : "避障关闭");
     }
 }
 
+void handlePower() {
+    markActivity();
+    if (server.hasArg("idleTimeout")) {
+        int seconds = constrain(server.arg("idleTimeout").toInt(), 1, 3600);
+        powerGovernor.setIdleTimeout(seconds * 1000UL);
+        server.send(200, "text/plain", "Idle timeout: " + String(seconds) + "s");
+    }
+}
+
 void handleData() {
+    TelemetryData data;
+    
+    portENTER_CRITICAL(&motionMux);
+    const Odometry& odom = driveController.odometry();
+    data.wheelLeft = driveController.leftSpeed();
+    data.wheelRight = driveController.rightSpeed();
+    data.speed = (data.wheelLeft + data.wheelRight) * 0.5f * odom.mmPerTick() / 10.0f;
+    data.odomX = odom.x() / 10.0f;
+    data.odomY = odom.y() / 10.0f;
+    data.heading = odom.heading() * RAD_TO_DEG;
+    portEXIT_CRITICAL(&motionMux);
+    
     // 模拟传感器数据（实际项目需要连接真实传感器）
-    String json = "{";
-    json += "\"distance\":\"" + String(readDistance()) + "\",";
-    json += "\"battery\":\"" + String(random(80, 100)) + "\",";
-    json += "\"temperature\":\"" + String(random(20, 35)) + "\",";
-    json += "\"rssi\":\"" + String(WiFi.RSSI()) + "\",";
-    json += "\"memory\":\"" + String(ESP.getFreeHeap() / 1024) + "\",";
-    json += "\"uptime\":\"" + String(millis() / 1000) + "\"";
-    json += "}";
+    data.distance = readDistance();
+    data.battery = random(80, 100);
+    data.temperature = random(20, 35);
+    data.rssi = WiFi.RSSI();
+    data.memoryKb = ESP.getFreeHeap() / 1024;
+    data.uptime = millis() / 1000;
+    data.power = powerGovernor.stateName();
+    data.cpuMhz = getCpuFrequencyMhz();
+    data.idleEntries = powerGovernor.idleEntries();
+    data.wakeups = powerGovernor.wakeups();
+    data.idleTime = powerGovernor.idleTimeMs(millis()) / 1000;
     
+    char json[TELEMETRY_JSON_SIZE];
+    formatTelemetry(json, sizeof(json), data);
     server.send(200, "application/json", json);
 }
 
@@ -676,6 +841,7 @@ void initWebServer() {
     server.on("/servo", handleServo);
     server.on("/led", handleLED);
     server.on("/avoidance", handleAvoidance);
+    server.on("/power", handlePower);
     server.on("/data", handleData);
     
     // 处理未找到的页面
@@ -690,6 +856,9 @@ void initWebServer() {
 // ====================== 主程序 ======================
 void setup() {
     initGPIO();
+    xTaskCreatePinnedToCore(speedLoopTask, "speedLoop", 4096, NULL, 2, &speedLoopHandle, 1);
+    loopTaskHandle = xTaskGetCurrentTaskHandle();
+    attachInterrupt(digitalPinToInterrupt(Board::BUTTON), onButtonPress, FALLING);
     initWiFiAP();
     initWebServer();
     
@@ -718,11 +887,12 @@ void loop() {
     obstacleAvoidanceTask();
     
     // 检查按钮
-    if (digitalRead(BUTTON_PIN) == LOW) {
+    if (digitalRead(Board::BUTTON) == LOW) {
         delay(50); // 消抖
-        if (digitalRead(BUTTON_PIN) == LOW) {
+        if (digitalRead(Board::BUTTON) == LOW) {
             Serial.println("按钮按下，停止小车");
-            controlCar("stop");
+            markActivity();
+            controlCar(CarCommand::Stop);
             delay(1000);
         }
     }
@@ -734,4 +904,8 @@ void loop() {
         strip.setPixelColor(0, millis() % 2000 < 1000 ? 0x00FF00 : 0x000000);
         strip.show();
     }
+    
+    // 空闲功耗管理
+    powerTask();
+    idleWait();
 }
\ No newline at end of file
@@ -0,0 +1,286 @@
+// 主机端基准测试：控制、序列化、LED 渲染、避障决策与功耗管理路径
+//
+//   pio test -e native -v
+//
+// 每项报告 ns/op 与 allocs/op（operator new 次数），结果写入 bench_results.json，
+// 可通过环境变量 ESP_CAR_BENCH_OUT 指定输出路径，ESP_CAR_BENCH_LABEL 标注固件版本，
+// 用于刷写车队前对比不同版本。
+
+#include <unity.h>
+
+#include <chrono>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <Avoidance.h>
+#include <CarCommand.h>
+#include <DriveController.h>
+#include <LedFrame.h>
+#include <PowerGovernor.h>
+#include <Telemetry.h>
+
+// ====================== 分配计数 ======================
+static unsigned long allocCount = 0;
+
+void* operator new(size_t size) {
+    allocCount++;
+    void* p = malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+// ====================== 计时框架 ======================
+template <typename T>
+static inline void keep(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+struct BenchResult {
+    const char* name;
+    double nsPerOp;
+    double allocsPerOp;
+    unsigned long iterations;
+};
+
+static const int BENCH_ROUNDS = 5;
+static const double MIN_ROUND_NS = 20e6;  // 每轮至少 20ms
+static const unsigned long MAX_ITERATIONS = 100000000UL;
+
+static BenchResult results[16];
+static size_t resultCount = 0;
+
+// 先把迭代次数加到单轮足够长，再取多轮中的最小 ns/op
+template <typename Body>
+static void runBench(const char* name, Body body) {
+    typedef std::chrono::steady_clock Clock;
+
+    unsigned long iterations = 1000;
+    double elapsed = 0;
+    for (;;) {
+        Clock::time_point start = Clock::now();
+        for (unsigned long i = 0; i < iterations; i++) body(i);
+        elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        if (elapsed >= MIN_ROUND_NS || iterations >= MAX_ITERATIONS) break;
+        iterations *= 10;
+    }
+
+    double best = elapsed / iterations;
+    unsigned long allocs = 0;
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        unsigned long allocBefore = allocCount;
+        Clock::time_point start = Clock::now();
+        for (unsigned long i = 0; i < iterations; i++) body(i);
+        elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        allocs = allocCount - allocBefore;
+        if (elapsed / iterations < best) best = elapsed / iterations;
+    }
+
+    BenchResult& r = results[resultCount++];
+    r.name = name;
+    r.nsPerOp = best;
+    r.allocsPerOp = static_cast<double>(allocs) / iterations;
+    r.iterations = iterations;
+    printf("%-24s %10.1f ns/op %8.3f allocs/op  (%lu iterations)\n",
+           name, r.nsPerOp, r.allocsPerOp, iterations);
+}
+
+// 按 JSON 字符串规则转义输出（标签来自环境变量，可能含引号或反斜杠）
+static void writeJsonString(FILE* f, const char* text) {
+    fputc('"', f);
+    for (const char* p = text; *p; p++) {
+        unsigned char c = static_cast<unsigned char>(*p);
+        if (c == '"' || c == '\\') fprintf(f, "\\%c", c);
+        else if (c < 0x20) fprintf(f, "\\u%04x", c);
+        else fputc(c, f);
+    }
+    fputc('"', f);
+}
+
+static void writeResults() {
+    const char* path = getenv("ESP_CAR_BENCH_OUT");
+    if (!path) path = "bench_results.json";
+    const char* label = getenv("ESP_CAR_BENCH_LABEL");
+    if (!label) label = "local";
+
+    FILE* f = fopen(path, "w");
+    if (!f) {
+        printf("无法写入 %s\n", path);
+        return;
+    }
+    fprintf(f, "{\n  \"label\": ");
+    writeJsonString(f, label);
+    fprintf(f, ",\n  \"compiler\": ");
+    writeJsonString(f, __VERSION__);
+    fprintf(f, ",\n  \"results\": [\n");
+    for (size_t i = 0; i < resultCount; i++) {
+        const BenchResult& r = results[i];
+        fprintf(f, "    {\"name\": \"%s\", \"ns_per_op\": %.2f, \"allocs_per_op\": %.3f, \"iterations\": %lu}%s\n",
+                r.name, r.nsPerOp, r.allocsPerOp, r.iterations, i + 1 < resultCount ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    fclose(f);
+    printf("结果已写入 %s\n", path);
+}
+
+// ====================== 基准项 ======================
+// 与 main.cpp 中 LED_COUNT 一致
+static const size_t LED_COUNT = 8;
+
+static const char* const COMMANDS[] = {"forward", "backward", "left", "right", "stop", "honk"};
+static const size_t COMMAND_COUNT = sizeof(COMMANDS) / sizeof(COMMANDS[0]);
+
+void setUp() {}
+void tearDown() {}
+
+void bench_command_parse() {
+    TEST_ASSERT_EQUAL(CarCommand::Backward, parseCommand("backward"));
+    TEST_ASSERT_EQUAL(CarCommand::Unknown, parseCommand("stopp"));
+    TEST_ASSERT_EQUAL(CarCommand::Unknown, parseCommand(""));
+
+    runBench("command_parse", [](unsigned long i) {
+        keep(parseCommand(COMMANDS[i % COMMAND_COUNT]));
+    });
+}
+
+// controlCar() 去掉硬件输出后的部分：解析 + 生成电机/灯光方案
+void bench_command_dispatch() {
+    DrivePlan plan;
+    TEST_ASSERT_TRUE(planCommand(parseCommand("left"), 200, plan));
+    TEST_ASSERT_EQUAL(100, plan.leftSpeed);
+    TEST_ASSERT_EQUAL(200, plan.rightSpeed);
+
+    runBench("command_dispatch", [](unsigned long i) {
+        DrivePlan p;
+        bool ok = planCommand(parseCommand(COMMANDS[i % COMMAND_COUNT]), static_cast<int>(i & 255), p);
+        keep(ok);
+        keep(p);
+    });
+}
+
+// handleData() 的 JSON 生成
+void bench_telemetry_json() {
+    TelemetryData data = {23.5f, 88, 27, -54, 180, 3600, 31.2f, 2950, 3010, 120.4f, -8.2f, 12.5f,
+                          "idle", 80, 3, 2, 1250};
+    char json[TELEMETRY_JSON_SIZE];
+    TEST_ASSERT_TRUE(formatTelemetry(json, sizeof(json), data) > 0);
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"distance\":\"23.50\",\"battery\":\"88\",\"temperature\":\"27\",\"rssi\":\"-54\","
+        "\"memory\":\"180\",\"uptime\":\"3600\",\"speed\":\"31.2\",\"wheelL\":\"2950\","
+        "\"wheelR\":\"3010\",\"odomX\":\"120.4\",\"odomY\":\"-8.2\",\"heading\":\"12.5\","
+        "\"power\":\"idle\",\"cpuMhz\":\"80\",\"idleCount\":\"3\",\"wakeCount\":\"2\",\"idleTime\":\"1250\"}",
+        json);
+    TEST_ASSERT_EQUAL(0, formatTelemetry(json, 16, data));
+
+    runBench("telemetry_json", [&data](unsigned long i) {
+        char out[TELEMETRY_JSON_SIZE];
+        data.uptime = static_cast<uint32_t>(i);
+        data.distance = static_cast<float>(i % 400);
+        keep(formatTelemetry(out, sizeof(out), data));
+        keep(out[0]);
+    });
+}
+
+// setLEDColor() 的帧计算
+void bench_led_solid() {
+    uint32_t frame[LED_COUNT];
+    fillSolid(frame, LED_COUNT, 255, 255, 0);
+    TEST_ASSERT_EQUAL_HEX32(0xFFFF00, frame[LED_COUNT - 1]);
+
+    runBench("led_solid", [&frame](unsigned long i) {
+        fillSolid(frame, LED_COUNT, static_cast<uint8_t>(i), 0, 255);
+        keep(frame);
+    });
+}
+
+// rainbowLED() 的帧计算
+void bench_led_rainbow() {
+    uint32_t frame[LED_COUNT];
+    fillRainbow(frame, LED_COUNT, 0);
+    TEST_ASSERT_EQUAL_HEX32(0xFF0000, frame[0]);
+    TEST_ASSERT_EQUAL_HEX32(0x00FFFF, frame[LED_COUNT / 2]);
+    TEST_ASSERT_EQUAL_HEX32(0xFF0000, hueToColor(65535));
+
+    runBench("led_rainbow", [&frame](unsigned long i) {
+        fillRainbow(frame, LED_COUNT, static_cast<uint16_t>(i * 256));
+        keep(frame);
+    });
+}
+
+// obstacleAvoidanceTask() 的决策部分：回波时间 -> 距离 -> 动作序列
+void bench_avoidance_decision() {
+    size_t steps = 0;
+    TEST_ASSERT_NULL(planAvoidance(echoToDistance(0), steps));
+    TEST_ASSERT_EQUAL(0, steps);
+    const AvoidStep* plan = planAvoidance(echoToDistance(588), steps);  // 约 10cm
+    TEST_ASSERT_NOT_NULL(plan);
+    TEST_ASSERT_EQUAL(CarCommand::Stop, plan[0].command);
+    TEST_ASSERT_EQUAL(CarCommand::Forward, plan[steps - 1].command);
+
+    runBench("avoidance_decision", [](unsigned long i) {
+        size_t count = 0;
+        keep(planAvoidance(echoToDistance(static_cast<long>(i % 3000)), count));
+        keep(count);
+    });
+}
+
+// 速度环任务每周期的计算：两路 PID + 里程计
+void bench_speed_loop() {
+    DriveController controller({0.03f, 0.6f, 0.0f, 255.0f / 6000.0f}, {1320, 65, 150});
+    controller.setTarget(3000, -3000);
+    controller.update(0, 0, 0.02f);
+    controller.update(60, -60, 0.02f);
+    TEST_ASSERT_TRUE(controller.leftOutput().forward);
+    TEST_ASSERT_FALSE(controller.rightOutput().forward);
+
+    int32_t count = 60;
+    runBench("speed_loop", [&](unsigned long i) {
+        count += 55 + static_cast<int32_t>(i & 7);
+        controller.update(count, -count, 0.02f);
+        keep(controller.leftOutput());
+    });
+}
+
+// loop() 每次迭代的空闲判断
+void bench_power_governor() {
+    PowerGovernor governor(1000);
+    TEST_ASSERT_EQUAL(PowerTransition::None, governor.update(500, true));
+    TEST_ASSERT_EQUAL(PowerTransition::EnterIdle, governor.update(1000, true));
+    TEST_ASSERT_EQUAL(PowerTransition::None, governor.update(1500, true));
+    governor.noteActivity(1600);
+    TEST_ASSERT_EQUAL(PowerTransition::Wake, governor.update(1600, true));
+    TEST_ASSERT_EQUAL(600, governor.idleTimeMs(1700));
+    // 不允许空闲（如开启避障）时立即唤醒，并且不会再次进入空闲
+    TEST_ASSERT_EQUAL(PowerTransition::EnterIdle, governor.update(2600, true));
+    TEST_ASSERT_EQUAL(PowerTransition::Wake, governor.update(2700, false));
+    TEST_ASSERT_EQUAL(PowerTransition::None, governor.update(9000, false));
+    TEST_ASSERT_EQUAL(PowerState::Active, governor.state());
+
+    runBench("power_governor", [&governor](unsigned long i) {
+        uint32_t now = static_cast<uint32_t>(i);
+        if ((i & 4095) == 0) governor.noteActivity(now);
+        keep(governor.update(now, true));
+    });
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(bench_command_parse);
+    RUN_TEST(bench_command_dispatch);
+    RUN_TEST(bench_telemetry_json);
+    RUN_TEST(bench_led_solid);
+    RUN_TEST(bench_led_rainbow);
+    RUN_TEST(bench_avoidance_decision);
+    RUN_TEST(bench_speed_loop);
+    RUN_TEST(bench_power_governor);
+    writeResults();
+    return UNITY_END();
+}
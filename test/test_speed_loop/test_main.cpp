@@ -0,0 +1,153 @@
+// 速度闭环测试：DriveController 通过模拟 HAL（SimMotor + WheelEncoder::simAddTicks）闭环运行
+//
+//   pio test -e native -f test_speed_loop
+
+#include <unity.h>
+
+#include <math.h>
+
+#include <DriveController.h>
+#include <SimMotor.h>
+#include <WheelEncoder.h>
+
+// 与 main.cpp 的速度环配置一致
+static const float MAX_WHEEL_TPS = 6000.0f;
+static const float PERIOD_S = 0.02f;
+static const int SIM_STEPS_PER_PERIOD = 20;  // 模型以 1ms 步长推进
+static const PidGains GAINS = {0.03f, 0.6f, 0.0f, 255.0f / MAX_WHEEL_TPS};
+static const OdometryConfig ODOMETRY = {1320, 65, 150};
+static const SimMotorParams MOTOR = {MAX_WHEEL_TPS, 20, 0.08f};
+
+struct SimCar {
+    WheelEncoder leftEncoder;
+    WheelEncoder rightEncoder;
+    SimMotor leftMotor;
+    SimMotor rightMotor;
+    DriveController controller;
+
+    explicit SimCar(bool quadrature)
+        : leftMotor(MOTOR, &leftEncoder), rightMotor(MOTOR, &rightEncoder), controller(GAINS, ODOMETRY) {
+        leftEncoder.begin(0, quadrature ? 1 : -1);
+        rightEncoder.begin(2, quadrature ? 3 : -1);
+    }
+
+    // 运行若干秒，返回最后 0.2s 的平均轮速
+    void run(float seconds, float& leftAvg, float& rightAvg) {
+        int periods = static_cast<int>(seconds / PERIOD_S + 0.5f);
+        leftAvg = rightAvg = 0;
+        for (int i = 0; i < periods; i++) {
+            for (int k = 0; k < SIM_STEPS_PER_PERIOD; k++) {
+                leftMotor.step(PERIOD_S / SIM_STEPS_PER_PERIOD);
+                rightMotor.step(PERIOD_S / SIM_STEPS_PER_PERIOD);
+            }
+            controller.update(leftEncoder.read(), rightEncoder.read(), PERIOD_S);
+            WheelOutput left = controller.leftOutput();
+            WheelOutput right = controller.rightOutput();
+            leftEncoder.setDirection(left.forward);
+            rightEncoder.setDirection(right.forward);
+            leftMotor.drive(left.pwm, left.forward);
+            rightMotor.drive(right.pwm, right.forward);
+            if (i >= periods - 10) {
+                leftAvg += controller.leftSpeed() / 10;
+                rightAvg += controller.rightSpeed() / 10;
+            }
+        }
+    }
+};
+
+#define ASSERT_NEAR_TARGET(target, actual) TEST_ASSERT_FLOAT_WITHIN(fabsf(target) * 0.05f, target, actual)
+
+void setUp() {}
+void tearDown() {}
+
+void test_settles_at_target() {
+    SimCar car(true);
+    float left, right;
+    car.controller.setTarget(3000, 3000);
+    car.run(2.0f, left, right);
+    ASSERT_NEAR_TARGET(3000.0f, left);
+    ASSERT_NEAR_TARGET(3000.0f, right);
+
+    TEST_ASSERT_FALSE(car.controller.feedbackLost());
+
+    // 两轮同速直行：航向基本不变，x 方向前进
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 0.0f, car.controller.odometry().heading());
+    TEST_ASSERT_TRUE(car.controller.odometry().x() > 500.0f);
+}
+
+void test_recovers_after_battery_sag() {
+    SimCar car(true);
+    float left, right;
+    car.controller.setTarget(3000, 3000);
+    car.run(2.0f, left, right);
+
+    car.leftMotor.setSupplyScale(0.7f);
+    car.rightMotor.setSupplyScale(0.7f);
+    car.run(2.0f, left, right);
+    ASSERT_NEAR_TARGET(3000.0f, left);
+    ASSERT_NEAR_TARGET(3000.0f, right);
+}
+
+void test_recovers_after_load_change() {
+    SimCar car(true);
+    float left, right;
+    car.controller.setTarget(3000, 3000);
+    car.run(2.0f, left, right);
+
+    car.rightMotor.setLoad(0.3f);
+    car.run(2.0f, left, right);
+    ASSERT_NEAR_TARGET(3000.0f, left);
+    ASSERT_NEAR_TARGET(3000.0f, right);
+}
+
+void test_single_channel_reverse() {
+    SimCar car(false);
+    float left, right;
+    car.controller.setTarget(-2000, -2000);
+    car.run(2.0f, left, right);
+    ASSERT_NEAR_TARGET(-2000.0f, left);
+    ASSERT_NEAR_TARGET(-2000.0f, right);
+    TEST_ASSERT_TRUE(car.controller.odometry().x() < -300.0f);
+}
+
+void test_stop_releases_motors() {
+    SimCar car(true);
+    float left, right;
+    car.controller.setTarget(3000, 3000);
+    car.run(1.0f, left, right);
+    car.controller.setTarget(0, 0);
+    car.run(1.0f, left, right);
+    TEST_ASSERT_EQUAL(0, car.controller.leftOutput().pwm);
+    TEST_ASSERT_EQUAL(0, car.controller.rightOutput().pwm);
+    TEST_ASSERT_FLOAT_WITHIN(50.0f, 0.0f, left);
+}
+
+// 编码器未接：计数一直为 0，输出饱和后判定为无反馈
+void test_detects_missing_encoder() {
+    DriveController controller(GAINS, ODOMETRY);
+    controller.setTarget(3000, 3000);
+    for (int i = 0; i < 5; i++) controller.update(0, 0, PERIOD_S);
+    TEST_ASSERT_FALSE(controller.feedbackLost());
+    // 积分需要一两个周期才把输出推到饱和
+    for (int i = 0; i < DriveController::NO_FEEDBACK_PERIODS; i++) controller.update(0, 0, PERIOD_S);
+    TEST_ASSERT_EQUAL(255, controller.leftOutput().pwm);
+    TEST_ASSERT_TRUE(controller.feedbackLost());
+
+    // 停车不算无反馈
+    controller.setTarget(0, 0);
+    controller.update(0, 0, PERIOD_S);
+    TEST_ASSERT_FALSE(controller.feedbackLost());
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_settles_at_target);
+    RUN_TEST(test_recovers_after_battery_sag);
+    RUN_TEST(test_recovers_after_load_change);
+    RUN_TEST(test_single_channel_reverse);
+    RUN_TEST(test_stop_releases_motors);
+    RUN_TEST(test_detects_missing_encoder);
+    return UNITY_END();
+}